@@ -0,0 +1,45 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TRACE_ANALYZER_H_
+#define _TRACE_ANALYZER_H_
+
+#include <stdint.h>
+
+/* Binary outputs of trace-analyzer, also read by utils/map_optimizer */
+
+#define ANALYZER_MAGIC "TRANLYZ1"
+
+struct AnalyzerHeader {
+  char magic[8];
+  int64_t numRanks;
+  int64_t numRecords;
+};
+
+struct AnalyzerRankRecord {
+  int64_t tasks;
+  double computeTime; //s
+  int64_t sends, sendBytes;
+  int64_t recvs;
+  int64_t collectives;
+};
+
+struct AnalyzerMatrixRecord {
+  int32_t src, dst;
+  int64_t messages, bytes;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#!/usr/bin/env python3
+##############################################################################
+# Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+# Produced at the Lawrence Livermore National Laboratory.
+#
+# Written by:
+#     Nikhil Jain <nikhil.jain@acm.org>
+#     Bilge Acun <acun2@illinois.edu>
+#     Abhinav Bhatele <bhatele@llnl.gov>
+#
+# LLNL-CODE-681378. All rights reserved.
+#
+# This file is part of TraceR. For details, see:
+# https://github.com/LLNL/tracer
+# Please also read the LICENSE file for our notice and the LGPL.
+##############################################################################
+
+"""Benchmark the performance of TraceR itself on the bundled sample traces.
+
+Runs traceR over the matrix
+  sample traces x network confs x sync mode x MPI ranks x job replication
+and writes one record per run to <out>.csv and <out>.json: wall time, ROSS
+event rate, rollback ratio, startup time (until all LPs have read their
+traces), peak RSS per rank and the simulated job times.
+
+The sample traces are tracer/stencil4d-otf for an OTF2 build and
+tracer/jacobi2d for a BigSim build. With --replicate N, the jobs of the
+sample are repeated N times in the generated tracer config, mapped linearly.
+
+Example, from the tracer directory:
+  python3 bench/tracer_bench.py --confs tracer-torus.conf --ranks 1,4
+"""
+
+import argparse
+import csv
+import glob
+import json
+import os
+import platform
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+TRACER_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SAMPLES = {
+    "otf": "stencil4d-otf",
+    "bigsim": "jacobi2d",
+}
+
+SYNC_NAMES = {1: "sequential", 2: "conservative", 3: "optimistic"}
+
+# patterns matched against the output of a run; the first match is used
+PATTERNS = {
+    "net_events": r"Net Events Processed\s+(\d+)",
+    "rolled_back": r"Events Rolled Back\s+(\d+)",
+    "event_rate": r"Event Rate \(events/sec\)\s+([\d.]+)",
+    "ross_running_s": r"Running Time\D*([\d.]+)",
+    "startup_s": r"Startup Time ([\d.]+) s",
+    "peak_rss_kb": r"Peak RSS (\d+) KB per rank",
+}
+
+FIELDS = ["trace", "conf", "sync", "sync_mode", "ranks", "replicate",
+          "repeat", "status", "wall_s", "ross_running_s", "startup_s",
+          "net_events", "event_rate", "rolled_back", "rollback_ratio",
+          "peak_rss_kb", "job_times_s"]
+
+
+def read_sample_jobs(sample_dir):
+    """Jobs of the sample tracer config as (trace, ranks, iterations)."""
+    with open(os.path.join(sample_dir, "tracer_config")) as f:
+        tokens = f.read().split()
+    num_jobs = int(tokens[1])
+    jobs = []
+    for i in range(num_jobs):
+        trace, _, ranks, iters = tokens[2 + 4 * i: 6 + 4 * i]
+        jobs.append((os.path.join(sample_dir, trace), int(ranks), int(iters)))
+    return jobs
+
+
+def write_tracer_config(path, jobs, replicate):
+    with open(path, "w") as f:
+        f.write("NA\n%d\n" % (len(jobs) * replicate))
+        for _ in range(replicate):
+            for trace, ranks, iters in jobs:
+                f.write("%s NA %d %d\n" % (trace, ranks, iters))
+
+
+def parse_output(text):
+    record = {}
+    for key, pattern in PATTERNS.items():
+        m = re.search(pattern, text)
+        if m:
+            value = m.group(1)
+            record[key] = float(value) if "." in value else int(value)
+    record["job_times_s"] = [float(t) for t in
+                             re.findall(r"^Job \d+ Time ([\d.]+) s", text,
+                                        re.MULTILINE)]
+    if record.get("net_events"):
+        record["rollback_ratio"] = (record.get("rolled_back", 0) /
+                                    float(record["net_events"]))
+    return record
+
+
+def run_one(args, trace_name, jobs, conf, sync, ranks, replicate, repeat):
+    workdir = tempfile.mkdtemp(prefix="tracer-bench-")
+    config = os.path.join(workdir, "tracer_config")
+    write_tracer_config(config, jobs, replicate)
+    cmd = args.mpirun.split() + ["-np", str(ranks), args.traceR,
+                                 "--sync=%d" % sync,
+                                 "--lp-io-dir=%s" % os.path.join(workdir, "out")]
+    cmd += args.ross_args.split()
+    cmd += ["--", conf, config]
+
+    record = {"trace": trace_name, "conf": os.path.basename(conf),
+              "sync": sync, "sync_mode": SYNC_NAMES[sync], "ranks": ranks,
+              "replicate": replicate, "repeat": repeat}
+    start = time.time()
+    try:
+        proc = subprocess.run(cmd, cwd=workdir, stdout=subprocess.PIPE,
+                              stderr=subprocess.STDOUT,
+                              universal_newlines=True, timeout=args.timeout)
+        output = proc.stdout
+        record["status"] = "ok" if proc.returncode == 0 else \
+            "failed (%d)" % proc.returncode
+    except subprocess.TimeoutExpired as e:
+        output = e.stdout or ""
+        if isinstance(output, bytes):
+            output = output.decode(errors="replace")
+        record["status"] = "timeout"
+    record["wall_s"] = time.time() - start
+    record.update(parse_output(output))
+
+    if args.keep_logs:
+        log = "%s-%s-%s-sync%d-np%d-x%d-%d.log" % (
+            args.out, trace_name, record["conf"], sync, ranks, replicate,
+            repeat)
+        with open(log, "w") as f:
+            f.write(" ".join(cmd) + "\n" + output)
+    shutil.rmtree(workdir, ignore_errors=True)
+    return record
+
+
+def int_list(text):
+    return [int(x) for x in text.split(",") if x]
+
+
+def git_revision():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "HEAD"],
+                                       cwd=TRACER_DIR,
+                                       universal_newlines=True).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--traceR", default=os.path.join(TRACER_DIR, "traceR"),
+                        help="traceR binary (default: %(default)s)")
+    parser.add_argument("--format", choices=sorted(SAMPLES), default="otf",
+                        help="trace format traceR was built for "
+                        "(default: %(default)s)")
+    parser.add_argument("--confs", default="",
+                        help="comma separated confs from tracer/conf "
+                        "(default: all tracer-*.conf)")
+    parser.add_argument("--sync", type=int_list, default=[1, 2, 3],
+                        help="sync modes (default: 1,2,3)")
+    parser.add_argument("--ranks", type=int_list, default=[1, 2, 4],
+                        help="MPI rank counts; sequential runs use 1 "
+                        "(default: 1,2,4)")
+    parser.add_argument("--replicate", type=int_list, default=[1],
+                        help="number of copies of the sample jobs "
+                        "(default: 1)")
+    parser.add_argument("--repeat", type=int, default=1,
+                        help="runs of every configuration (default: 1)")
+    parser.add_argument("--mpirun", default="mpirun",
+                        help="MPI launcher (default: %(default)s)")
+    parser.add_argument("--ross-args",
+                        default="--nkp=16 --extramem=100000 "
+                        "--max-opt-lookahead=1000000",
+                        help="extra traceR/ROSS options "
+                        "(default: %(default)s)")
+    parser.add_argument("--timeout", type=float, default=3600,
+                        help="seconds after which a run is killed")
+    parser.add_argument("--out", default="bench-results",
+                        help="prefix of the .csv and .json results")
+    parser.add_argument("--keep-logs", action="store_true",
+                        help="keep the output of every run as <out>-*.log")
+    args = parser.parse_args()
+    args.traceR = os.path.abspath(args.traceR)
+
+    if not os.path.exists(args.traceR):
+        sys.exit("traceR binary %s not found; build it first" % args.traceR)
+
+    conf_dir = os.path.join(TRACER_DIR, "conf")
+    if args.confs:
+        confs = [os.path.join(conf_dir, c) for c in args.confs.split(",")]
+    else:
+        confs = sorted(glob.glob(os.path.join(conf_dir, "tracer-*.conf")))
+
+    trace_name = SAMPLES[args.format]
+    jobs = read_sample_jobs(os.path.join(TRACER_DIR, trace_name))
+
+    records = []
+    for conf in confs:
+        for sync in args.sync:
+            ranks_list = [1] if sync == 1 else args.ranks
+            for ranks in ranks_list:
+                for replicate in args.replicate:
+                    for repeat in range(args.repeat):
+                        record = run_one(args, trace_name, jobs, conf, sync,
+                                         ranks, replicate, repeat)
+                        records.append(record)
+                        print("%-14s %-24s %-12s np %-3d x%-3d %-10s "
+                              "wall %8.2f s rate %s" % (
+                                  trace_name, record["conf"],
+                                  record["sync_mode"], ranks, replicate,
+                                  record["status"], record["wall_s"],
+                                  record.get("event_rate", "-")))
+                        sys.stdout.flush()
+
+    with open(args.out + ".csv", "w") as f:
+        writer = csv.DictWriter(f, fieldnames=FIELDS)
+        writer.writeheader()
+        for record in records:
+            row = dict(record)
+            row["job_times_s"] = ";".join(str(t) for t in
+                                          record.get("job_times_s", []))
+            writer.writerow(row)
+    with open(args.out + ".json", "w") as f:
+        json.dump({"git_revision": git_revision(),
+                   "host": platform.node(),
+                   "traceR": args.traceR,
+                   "ross_args": args.ross_args,
+                   "runs": records}, f, indent=2)
+    print("Wrote %s.csv and %s.json" % (args.out, args.out))
+
+
+if __name__ == "__main__":
+    main()
@@ -46,6 +46,7 @@ bool PE_noMsgDep(PE* p, int, int tInd);
 int PE_get_iter(PE* p);
 void PE_inc_iter(PE* p);
 void PE_dec_iter(PE* p);
+void PE_commit_iter(PE* p, int iter);
 double PE_getTaskExecTime(PE* p, int tInd);
 void PE_addTaskExecTime(PE* p, int tInd, double time);
 #if TRACER_BIGSIM_TRACES
@@ -95,10 +96,13 @@ int* TraceReader_getOffsets(TraceReader* t);
 void TraceReader_setOffsets(TraceReader* t, int** offsets);
 void TraceReader_readTrace(TraceReader* t, int* tot, int* numnodes, int* empes,
     int* nwth, PE* pe, int penum, int jobnum, double* startTime);
+void TraceReader_readLocalTraces(TraceReader* t, int jobnum, PE** localPEs);
 int TraceReader_totalWorkerProcs(TraceReader* t);
 #endif
 void addEventSub(int job, char *key, double val, int numjobs);
 void addMsgSizeSub(int job, int64_t key, int64_t val, int numjobs);
+/* hash of the time and size substitutions in effect for job */
+uint64_t substitutionHash(int job);
 
 bool isPEonThisRank(int jobID, int i);
 void TraceReader_readOTF2Trace(PE* pe, int my_pe_num, int my_job, double *startTime);
@@ -17,6 +17,7 @@
 #ifndef TRACEFILEREADER_H_
 #define TRACEFILEREADER_H_
 #include "assert.h"
+#include <cstdio>
 #if TRACER_BIGSIM_TRACES
 #include "blue.h"
 #include "blue_impl.h"
@@ -36,7 +37,15 @@ public:
     void loadTraceSummary();
     void readTrace(int* tot, int* numnodes, int* empes, int* nwth, PE* pe,
         int penum, int jobnum, double* startTime);
+    void readLocalTraces(int jobnum, PE** localPEs);
     void setTaskFromLog(Task *t, BgTimeLog* bglog, int taskPE, int emPE, int jobPEindex, PE* pe, int, bool, double);
+  private:
+    void findSkipMsgId(BgTimeLineRec &tlinerec, int jobnum);
+    void fillPE(BgTimeLineRec &tlinerec, PE* pe, int penum, int jobnum);
+    int offsetIndex(int penum);
+    FILE* spillFile();
+    FILE *spill; // tasks of the timelines streamed through a task window
+  public:
 #endif
 
     int numEmPes;	// number of emulation PEs, there is a trace file for each of them
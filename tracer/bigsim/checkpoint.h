@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <stdint.h>
+#include <cstdio>
+#include "entities/PE.h"
+
+// Snapshot of a PE right after its trace is loaded: the tasks, the initial
+// task status and, for BigSim traces, the message lookup tables. Nothing has
+// been simulated at that point, so a snapshot does not depend on the network,
+// the mapping or the CODES parameters, and later runs restore it instead of
+// reading the trace. One file is kept per PE in <dir>/<job>/<pe>.pe.
+// Substitutions and soft_delay_mpi are baked into the task times, so both
+// are recorded in the header and a snapshot taken with others is refused.
+#define PE_CHECKPOINT_VERSION 2
+
+struct PECheckpointHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t taskSize;
+  uint32_t bigsim;       // 1 for BigSim traces, 0 for OTF2 traces
+  uint32_t noCommBuild;
+  int32_t job, pe;
+  int32_t numRanks;
+  int32_t tasksCount;
+  int32_t firstTask;
+  int32_t myEmPE, numWth, numEmPes;
+  double softDelay;
+  uint64_t substitutions;
+  double startTime;
+  char traceDir[256];
+};
+
+void peCheckpointStore(const char *dir, PE *pe, double startTime);
+
+/* Restore PE peNum of job jobID; returns NULL if its snapshot is missing or
+ * was taken for another trace or build */
+PE* peCheckpointLoad(const char *dir, int jobID, int peNum,
+  double *startTime);
+
+/* The snapshot of one PE written to and read from any stream, e.g. one in
+ * memory; name identifies the stream in error messages */
+bool peCheckpointWrite(FILE *f, PE *pe, double startTime);
+PE* peCheckpointRead(FILE *f, int jobID, int peNum, double *startTime,
+  const char *name);
+
+#if TRACER_BIGSIM_TRACES
+/* One BigSim task and the arrays it points to, as kept in a snapshot; also
+ * how streamed timelines are spilled, see TraceReader::fillPE */
+bool peTaskWrite(FILE *f, const Task &t);
+bool peTaskRead(FILE *f, Task &t);
+#endif
+
+#if TRACER_OTF_TRACES
+// State of a running PE stopped at the start of iteration iter, once no
+// message is in flight: the tasks as modified by the run, the task status,
+// the matching tables, the message sequence numbers and the collective state.
+// It is kept next to the snapshot of the PE, in <dir>/<job>/<pe>.run, and is
+// applied to a PE restored from that snapshot. The network is not saved; it
+// is empty when the state is taken.
+#define PE_RUN_STATE_VERSION 1
+
+struct PERunStateHeader {
+  char magic[8];
+  uint32_t version;
+  int32_t job, pe;
+  int32_t iter;
+  int32_t numRanks, tasksCount, numComms;
+  uint64_t substitutions;
+  double stoppedAt;  // when the PE reached iter
+  double startedAt;  // when the PE started, for the job time
+};
+
+/* Returns false if the state cannot be saved, e.g. a collective is open */
+bool peRunStateStore(const char *dir, PE *pe, int iter, double stoppedAt,
+  double startedAt);
+
+/* Apply the state saved at iteration iter to a PE restored from its
+ * snapshot; returns false if the state is missing or does not match */
+bool peRunStateLoad(const char *dir, PE *pe, int iter, double *stoppedAt,
+  double *startedAt);
+#endif
+
+#endif
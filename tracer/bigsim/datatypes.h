@@ -24,6 +24,14 @@
 #include <map>
 #include <list>
 
+#if TRACER_BIGSIM_TRACES
+class PE;
+class TraceReader;
+#endif
+#if TRACER_OTF_TRACES
+struct Motif;
+#endif
+
 struct TaskPair {
   int iter;
   int taskid;
@@ -60,10 +68,19 @@ typedef struct JobInf {
     int *offsets;
     int skipMsgId;
     int numIters;
+    //stop at steady state: relative tolerance of the iteration times and
+    //number of iterations compared; steadyWindow 0 disables it
+    double steadyTol;
+    int steadyWindow;
+#if TRACER_BIGSIM_TRACES
+    TraceReader *traceReader;
+    PE **localPEs; // PEs of this job hosted on this process, indexed by rank
+#endif
 #if TRACER_OTF_TRACES
     AllData *allData;
     OTF2_Reader *reader;
     bool localDefs;
+    Motif *motif; //synthetic workload, NULL if read from an OTF2 archive
 #endif
 } JobInf;
 
@@ -0,0 +1,152 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef COLLTABLE_H_
+#define COLLTABLE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+/* Number of collective messages that arrived before the PE reached the step
+ * that consumes them, per communicator, sequence number and sender group
+ * rank. Communicators are given by their dense index (GlobalDefs::commIndex),
+ * as for collectiveSeq. Only a few sequence numbers of a communicator are
+ * open at a time, so each communicator keeps a ring of slots indexed by the
+ * sequence number modulo its size; the ring doubles when two open sequences
+ * collide. A slot holds a count array indexed by group rank and is released
+ * as soon as all its counts are zero, so a missing entry and a zero count are
+ * the same.
+ */
+class CollPendingTable {
+  public:
+    CollPendingTable() : openSeqs(0) {}
+
+    int get(int64_t comm, int64_t seq, int rank) const {
+      const Slot *s = findSlot(comm, seq);
+      if(s == NULL || rank >= (int)s->counts.size()) return 0;
+      return s->counts[rank];
+    }
+    int inc(int64_t comm, int64_t seq, int rank) {
+      return add(comm, seq, rank, 1);
+    }
+    int dec(int64_t comm, int64_t seq, int rank) {
+      return add(comm, seq, rank, -1);
+    }
+    void set(int64_t comm, int64_t seq, int rank, int value) {
+      add(comm, seq, rank, value - get(comm, seq, rank));
+    }
+    //drop all counts of a sequence
+    void erase(int64_t comm, int64_t seq) {
+      Slot *s = findSlot(comm, seq);
+      if(s != NULL) freeSlot(*s);
+    }
+    //number of open sequences over all communicators
+    size_t size() const { return openSeqs; }
+
+  private:
+    struct Slot {
+      int64_t seq;
+      int nonZero;
+      std::vector<int> counts;
+      Slot() : seq(-1), nonZero(0) {}
+    };
+    typedef std::vector<Slot> Ring; //power of two slots
+
+    const Slot* findSlot(int64_t comm, int64_t seq) const {
+      if(comm < 0 || comm >= (int64_t)comms.size()) return NULL;
+      const Ring &r = comms[comm];
+      if(r.empty()) return NULL;
+      const Slot &s = r[seq & (r.size() - 1)];
+      return (s.seq == seq) ? &s : NULL;
+    }
+    Slot* findSlot(int64_t comm, int64_t seq) {
+      return const_cast<Slot*>(
+        static_cast<const CollPendingTable*>(this)->findSlot(comm, seq));
+    }
+
+    Slot* claimSlot(int64_t comm, int64_t seq) {
+      assert(comm >= 0 && seq >= 0);
+      if(comm >= (int64_t)comms.size()) comms.resize(comm + 1);
+      Ring &r = comms[comm];
+      if(r.empty()) r.resize(4);
+      while(true) {
+        Slot &s = r[seq & (r.size() - 1)];
+        if(s.seq == seq) return &s;
+        if(s.seq == -1) {
+          s.seq = seq;
+          openSeqs++;
+          return &s;
+        }
+        grow(r);
+      }
+    }
+
+    void grow(Ring &r) {
+      size_t n = r.size();
+      bool placed = false;
+      Ring bigger;
+      while(!placed) {
+        n *= 2;
+        bigger.clear();
+        bigger.resize(n);
+        placed = true;
+        for(size_t i = 0; i < r.size() && placed; i++) {
+          if(r[i].seq == -1) continue;
+          Slot &to = bigger[r[i].seq & (n - 1)];
+          if(to.seq != -1) {
+            placed = false;
+          } else {
+            to.seq = r[i].seq;
+          }
+        }
+      }
+      for(size_t i = 0; i < r.size(); i++) {
+        if(r[i].seq == -1) continue;
+        Slot &to = bigger[r[i].seq & (n - 1)];
+        to.nonZero = r[i].nonZero;
+        to.counts.swap(r[i].counts);
+      }
+      r.swap(bigger);
+    }
+
+    void freeSlot(Slot &s) {
+      s.seq = -1;
+      s.nonZero = 0;
+      std::vector<int>().swap(s.counts);
+      openSeqs--;
+    }
+
+    int add(int64_t comm, int64_t seq, int rank, int delta) {
+      if(delta == 0) return get(comm, seq, rank);
+      Slot *s = claimSlot(comm, seq);
+      if(rank >= (int)s->counts.size()) s->counts.resize(rank + 1, 0);
+      int old = s->counts[rank];
+      int value = old + delta;
+      assert(value >= 0);
+      s->counts[rank] = value;
+      if(old == 0) s->nonZero++;
+      else if(value == 0) s->nonZero--;
+      if(s->nonZero == 0) freeSlot(*s);
+      return value;
+    }
+
+    std::vector<Ring> comms; //indexed by communicator
+    size_t openSeqs;
+};
+
+#endif /* COLLTABLE_H_ */
@@ -0,0 +1,207 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef MATCHTABLE_H_
+#define MATCHTABLE_H_
+
+#include <cassert>
+#include <cstddef>
+#include <stdint.h>
+
+/* FIFO of matching entries; the first N entries are stored inline so the
+ * common case of one or two outstanding messages per key never allocates.
+ * Supports the push_front/pop_back operations used to undo pop_front and
+ * push_back in reverse handlers. N must be a power of two.
+ */
+template<typename T, int N = 2>
+class MatchQueue {
+  public:
+    MatchQueue() : heap(NULL), head(0), count(0), cap(N) {}
+    int size() const { return count; }
+    T& front() { return data()[head]; }
+    T& back() { return data()[(head + count - 1) & (cap - 1)]; }
+    T& at(int i) { return data()[(head + i) & (cap - 1)]; }
+    void push_back(const T& v) {
+      if(count == cap) grow();
+      data()[(head + count) & (cap - 1)] = v;
+      count++;
+    }
+    void push_front(const T& v) {
+      if(count == cap) grow();
+      head = (head + cap - 1) & (cap - 1);
+      data()[head] = v;
+      count++;
+    }
+    void pop_front() {
+      assert(count != 0);
+      head = (head + 1) & (cap - 1);
+      if(--count == 0) release();
+    }
+    void pop_back() {
+      assert(count != 0);
+      if(--count == 0) release();
+    }
+    //drop all entries and any overflow storage
+    void release() {
+      delete [] heap;
+      heap = NULL;
+      head = count = 0;
+      cap = N;
+    }
+
+  private:
+    T* data() { return heap ? heap : inl; }
+    void grow() {
+      T *bigger = new T[2 * cap];
+      T *old = data();
+      for(uint32_t i = 0; i < count; i++) {
+        bigger[i] = old[(head + i) & (cap - 1)];
+      }
+      delete [] heap;
+      heap = bigger;
+      head = 0;
+      cap *= 2;
+    }
+
+    T inl[N];
+    T *heap;
+    uint32_t head, count, cap;
+};
+
+template<typename T>
+inline void matchRelease(T &value) { }
+
+template<typename T, int N>
+inline void matchRelease(MatchQueue<T, N> &value) { value.release(); }
+
+inline uint64_t matchHashMix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+struct IntKeyHash {
+  uint64_t operator()(int key) const { return matchHashMix((uint32_t)key); }
+};
+
+/* Open addressing hash table with linear probing, used for the message
+ * matching state of a PE. Keys are compared with operator==. Erase uses
+ * backward shifting, so there are no tombstones and lookups stay short under
+ * the insert/erase churn of optimistic execution. Pointers returned by find
+ * and operator[] are invalidated by any later insert or erase.
+ */
+template<typename Key, typename Value, typename Hash>
+class MatchTable {
+  public:
+    MatchTable() : slots(NULL), capacity(0), count(0) {}
+    ~MatchTable() {
+      for(size_t i = 0; i < capacity; i++) {
+        if(slots[i].used) matchRelease(slots[i].value);
+      }
+      delete [] slots;
+    }
+
+    size_t size() const { return count; }
+
+    Value* find(const Key &key) {
+      if(count == 0) return NULL;
+      for(size_t i = home(key); slots[i].used; i = next(i)) {
+        if(slots[i].key == key) return &slots[i].value;
+      }
+      return NULL;
+    }
+
+    //find, inserting a default value if the key is absent
+    Value& operator[](const Key &key) {
+      if(2 * (count + 1) > capacity) rehash(capacity ? 2 * capacity : 16);
+      size_t i = home(key);
+      for(; slots[i].used; i = next(i)) {
+        if(slots[i].key == key) return slots[i].value;
+      }
+      slots[i].used = true;
+      slots[i].key = key;
+      slots[i].value = Value();
+      count++;
+      return slots[i].value;
+    }
+
+    void erase(const Key &key) {
+      if(count == 0) return;
+      size_t i = home(key);
+      for(; slots[i].used; i = next(i)) {
+        if(slots[i].key == key) break;
+      }
+      if(!slots[i].used) return;
+      matchRelease(slots[i].value);
+      count--;
+      //shift back later entries of the cluster that can move into the hole
+      size_t hole = i;
+      for(size_t j = next(i); slots[j].used; j = next(j)) {
+        size_t h = home(slots[j].key);
+        if(((j - h) & (capacity - 1)) >= ((j - hole) & (capacity - 1))) {
+          slots[hole] = slots[j];
+          hole = j;
+        }
+      }
+      slots[hole].used = false;
+      slots[hole].value = Value();
+    }
+
+    //call visit(key, value) for every entry, in no particular order
+    template<typename Visitor>
+    void forEach(Visitor &visit) {
+      for(size_t i = 0; i < capacity; i++) {
+        if(slots[i].used) visit(slots[i].key, slots[i].value);
+      }
+    }
+
+  private:
+    struct Slot {
+      Key key;
+      Value value;
+      bool used;
+      Slot() : used(false) {}
+    };
+
+    size_t home(const Key &key) const {
+      return hash(key) & (capacity - 1);
+    }
+    size_t next(size_t i) const { return (i + 1) & (capacity - 1); }
+
+    //entries are moved bitwise; values own no storage after being moved
+    void rehash(size_t newCapacity) {
+      Slot *old = slots;
+      size_t oldCapacity = capacity;
+      slots = new Slot[newCapacity];
+      capacity = newCapacity;
+      for(size_t s = 0; s < oldCapacity; s++) {
+        if(!old[s].used) continue;
+        size_t i = home(old[s].key);
+        while(slots[i].used) i = next(i);
+        slots[i] = old[s];
+      }
+      delete [] old;
+    }
+
+    Slot *slots;
+    size_t capacity, count;
+    Hash hash;
+};
+
+#endif /* MATCHTABLE_H_ */
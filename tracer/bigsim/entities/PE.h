@@ -20,6 +20,11 @@
 #include "MsgEntry.h"
 #include <cstring>
 #include "Task.h"
+#include "MatchTable.h"
+#include "CollTable.h"
+#include "TaskBuffer.h"
+#include "TaskStatus.h"
+#include "TaskWindow.h"
 #include <list>
 #include <map>
 #include <vector>
@@ -31,6 +36,7 @@ class MsgKey {
   public:
   uint32_t rank, comm, tag;
   int64_t seq;
+  MsgKey() { }
   MsgKey(uint32_t _rank, uint32_t _tag, uint32_t _comm, int64_t _seq) {
     rank = _rank; tag = _tag; comm = _comm; seq = _seq;
   }
@@ -41,14 +47,28 @@ class MsgKey {
     //else if(comm != rhs.comm) return comm < rhs.comm;
     //else return seq < rhs.seq;
   }
+  bool operator== (const MsgKey &rhs) const {
+    return rank == rhs.rank && tag == rhs.tag && comm == rhs.comm;
+  }
   ~MsgKey() { }
 };
-typedef std::map< MsgKey, std::list<int> > KeyType;
+
+struct MsgKeyHash {
+  uint64_t operator()(const MsgKey &key) const {
+    return matchHashMix((((uint64_t)key.rank << 32) | key.tag) ^
+      ((uint64_t)key.comm * 0x9e3779b97f4a7c15ULL));
+  }
+};
+typedef MatchQueue<int> MsgQueue;
+typedef MatchTable<MsgKey, MsgQueue, MsgKeyHash> KeyType;
+typedef MatchTable<int, int, IntKeyHash> ReqType;
+typedef MatchTable<int, int64_t, IntKeyHash> RReqType;
 
 class CollMsgKey {
   public:
   uint32_t rank, comm;
   int64_t seq;
+  CollMsgKey() { }
   CollMsgKey(uint32_t _rank, uint32_t _comm, int64_t _seq) {
     rank = _rank; comm = _comm; seq = _seq;
   }
@@ -57,28 +77,44 @@ class CollMsgKey {
     else if(comm != rhs.comm) return comm < rhs.comm;
     else return seq < rhs.seq;
   }
+  bool operator== (const CollMsgKey &rhs) const {
+    return rank == rhs.rank && comm == rhs.comm && seq == rhs.seq;
+  }
   ~CollMsgKey() { }
 };
-typedef std::map< CollMsgKey, std::list<int> > CollKeyType;
+
+struct CollMsgKeyHash {
+  uint64_t operator()(const CollMsgKey &key) const {
+    return matchHashMix((((uint64_t)key.rank << 32) | key.comm) ^
+      ((uint64_t)key.seq * 0x9e3779b97f4a7c15ULL));
+  }
+};
+typedef MatchTable<CollMsgKey, MsgQueue, CollMsgKeyHash> CollKeyType;
 
 class PE {
   public:
     PE();
     ~PE();
-    std::list<TaskPair> msgBuffer;
-    Task* myTasks;	// all tasks of this PE
-    bool **taskStatus, **taskExecuted;
-    bool **msgStatus;
-    bool *allMarked;
+    TaskBuffer msgBuffer;
+    Task* myTasks;	// all tasks of this PE, unless they are streamed
+    TaskWindow *window; // streamed tasks, NULL if all are in myTasks
+    inline Task* task(int tInd) {
+      return (window == NULL) ? &myTasks[tInd] : window->get(tInd);
+    }
+    TaskStatusWindow status; // done/executed/msg bits per iteration
     double currTime;
     bool busy;
     int beforeTask, totalTasksCount;
     int myNum, myEmPE, jobNum;
     int tasksCount;	//total number of tasks
     int currentTask; // index of first not-executed task (helps searching messages)
+    int lastBuffedTask; // last task taken from msgBuffer, kept while it runs
     int firstTask;
     int currIter;
+    int lastIter; // the loop is left at the end of this iteration
     int loop_start_task;
+    //task whose completion committed last; tasks before it are final
+    int committedIter, committedTask;
 
     bool noUnsatDep(int iter, int tInd);	// there is no unsatisfied dependency for task
     void mark_all_done(int iter, int tInd);
@@ -88,8 +124,18 @@ class PE {
     void printState();
 
     void invertMsgPe(int iter, int tInd);
+    bool isTaskExecuted(int iter, int tInd) {
+      return status.get(TASK_EXECUTED, iter, tInd);
+    }
+    void setTaskExecuted(int iter, int tInd, bool b) {
+      status.set(TASK_EXECUTED, iter, tInd, b);
+    }
+    //tasks that may still be accessed, for the task window
+    void pinnedTasks(std::vector<TaskRange> &pins);
     double getTaskExecTime(int tInd);
     void addTaskExecTime(int tInd, double time);
+    //time added to tasks that are streamed, applied when they are reloaded
+    MatchTable<int, double, IntKeyHash> addedExecTime;
     std::map<int, int>* msgDestLogs;
     int findTaskFromMsg(MsgID* msg);
     int numWth, numEmPes;
@@ -97,12 +143,12 @@ class PE {
     KeyType pendingMsgs;
     KeyType pendingRMsgs;
     int64_t *sendSeq, *recvSeq;
-    std::map<int, int> pendingReqs;
-    std::map<int, int64_t> pendingRReqs;
+    ReqType pendingReqs;
+    RReqType pendingRReqs;
 
     //handling collectives
     std::vector<int64_t> collectiveSeq;
-    std::map<int64_t, std::map<int64_t, std::map<int, int> > > pendingCollMsgs;
+    CollPendingTable pendingCollMsgs;
     CollKeyType pendingRCollMsgs;
     int64_t currentCollComm, currentCollSeq, currentCollTask, currentCollMsgSize;
     int currentCollRank, currentCollPartner, currentCollSize;
@@ -65,6 +65,9 @@ class Task {
     int64_t req_id;
     bool isNonBlocking;
     MsgEntry myEntry;
+    //collectives: index of the communicator in the definitions, and the
+    //rank of this PE in it
+    int32_t commIndex, commRank;
     bool beginEvent;
 #else
 #error Either TRACER_BIGSIM_TRACES or TRACER_OTF_TRACES should be 1
@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TASKBUFFER_H_
+#define TASKBUFFER_H_
+
+#include <cassert>
+#include <stdint.h>
+#include <vector>
+#include "datatypes.h"
+
+/* Deque of tasks that are ready to execute on a PE, stored in a ring buffer.
+ * A per-task count of buffered entries makes the duplicate check O(1); the
+ * buffer is only scanned when the same task is buffered for another
+ * iteration.
+ */
+class TaskBuffer {
+  public:
+    TaskBuffer() : ring(16), head(0), count(0) {}
+    int size() const { return count; }
+    TaskPair& front() { return ring[head]; }
+    TaskPair& back() { return ring[slot(count - 1)]; }
+    const TaskPair& at(int i) const { return ring[slot(i)]; }
+
+    bool contains(const TaskPair &t) const {
+      if(t.taskid < 0 || t.taskid >= (int)inBuffer.size() ||
+         inBuffer[t.taskid] == 0) {
+        return false;
+      }
+      for(int i = 0; i < count; i++) {
+        const TaskPair &e = ring[slot(i)];
+        if(e.iter == t.iter && e.taskid == t.taskid) return true;
+      }
+      return false;
+    }
+
+    void push_back(const TaskPair &t) {
+      if(count == (int)ring.size()) grow();
+      ring[slot(count)] = t;
+      count++;
+      mark(t);
+    }
+
+    void push_front(const TaskPair &t) {
+      if(count == (int)ring.size()) grow();
+      head = (head + ring.size() - 1) & (ring.size() - 1);
+      ring[head] = t;
+      count++;
+      mark(t);
+    }
+
+    void pop_front() {
+      assert(count > 0);
+      unmark(ring[head]);
+      head = (head + 1) & (ring.size() - 1);
+      count--;
+    }
+
+    void pop_back() {
+      assert(count > 0);
+      unmark(back());
+      count--;
+    }
+
+    //drop entries from the back until newSize are left
+    void resize(int newSize) {
+      assert(newSize <= count);
+      while(count > newSize) pop_back();
+    }
+
+    void clear() {
+      resize(0);
+      head = 0;
+    }
+
+  private:
+    int slot(int i) const { return (head + i) & (ring.size() - 1); }
+
+    void grow() {
+      std::vector<TaskPair> bigger(2 * ring.size());
+      for(int i = 0; i < count; i++) {
+        bigger[i] = ring[slot(i)];
+      }
+      ring.swap(bigger);
+      head = 0;
+    }
+
+    void mark(const TaskPair &t) {
+      if(t.taskid < 0) return;
+      if(t.taskid >= (int)inBuffer.size()) inBuffer.resize(t.taskid + 1, 0);
+      inBuffer[t.taskid]++;
+    }
+
+    void unmark(const TaskPair &t) {
+      if(t.taskid < 0) return;
+      inBuffer[t.taskid]--;
+    }
+
+    std::vector<TaskPair> ring; //power of two entries
+    std::vector<uint32_t> inBuffer;
+    int head, count;
+};
+
+#endif /* TASKBUFFER_H_ */
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TASKSTATUS_H_
+#define TASKSTATUS_H_
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+
+enum TaskStatusKind {
+  TASK_DONE = 0,      // task has completed (taskStatus)
+  TASK_EXECUTED,      // task has started executing (taskExecuted)
+  TASK_MSG_DONE,      // message the task depends on has arrived (msgStatus)
+  TASK_STATUS_KINDS
+};
+
+/* The window of a running PE, kept in a snapshot of it */
+struct TaskStatusState {
+  int32_t base, window;
+  int64_t evictedNotDone;
+  std::vector<char> marked;
+  std::vector<uint64_t> bits;
+};
+
+/* Per-task status bits of a PE for a window of iterations.
+ *
+ * Every iteration starts from the same initial bits, which are set while the
+ * trace is read. Only the iterations starting from the one before currIter
+ * are kept; an iteration beyond the window still has its initial bits, and
+ * the window grows if such an iteration is written. When the PE moves to the
+ * next iteration the oldest one is evicted; in optimistic mode its bits are
+ * saved so that rolling back the move restores them, and the saved copy is
+ * dropped once the move commits.
+ */
+class TaskStatusWindow {
+  public:
+    TaskStatusWindow();
+    void init(int numTasks, int numIters, int window, bool reversible);
+    void setInitial(TaskStatusKind kind, int task, bool value);
+    bool getInitial(TaskStatusKind kind, int task) const {
+      return (initial[kind * words + (task >> 6)] >> (task & 63)) & 1;
+    }
+    //fill the window from the initial bits, call once the trace is read
+    void activate();
+
+    inline bool get(TaskStatusKind kind, int iter, int task) const {
+      const uint64_t *w = (iter >= base + window) ? &initial[kind * words] :
+        &bits[(slot(iter) * TASK_STATUS_KINDS + kind) * words];
+      return (w[task >> 6] >> (task & 63)) & 1;
+    }
+    inline void set(TaskStatusKind kind, int iter, int task, bool value) {
+      uint64_t *w = wordsOf(kind, iter);
+      if(value) w[task >> 6] |= (1ULL << (task & 63));
+      else w[task >> 6] &= ~(1ULL << (task & 63));
+    }
+    inline void flip(TaskStatusKind kind, int iter, int task) {
+      wordsOf(kind, iter)[task >> 6] ^= (1ULL << (task & 63));
+    }
+    bool allMarked(int iter) const;
+    void setAllMarked(int iter);
+
+    //slide the window after currIter changed
+    void moveTo(int currIter);
+    //the move to iteration currIter has committed
+    void commit(int currIter);
+    //number of tasks not done, summed over all iterations
+    int64_t notDoneCount() const;
+
+    //the window once all moves have committed; restore replaces the
+    //window of an activated PE and returns false if it does not fit
+    void save(TaskStatusState &s) const;
+    bool restore(const TaskStatusState &s);
+
+  private:
+    struct Evicted {
+      int iter;
+      bool marked;
+      std::vector<uint64_t> bits;
+    };
+
+    inline int slot(int iter) const {
+      if(iter < base) evictedAccess(iter);
+      return iter % window;
+    }
+    inline uint64_t* wordsOf(TaskStatusKind kind, int iter) {
+      if(iter >= base + window) grow(iter);
+      return &bits[(slot(iter) * TASK_STATUS_KINDS + kind) * words];
+    }
+    void evictedAccess(int iter) const;
+    int baseFor(int currIter) const;
+    void grow(int iter);
+    void resetSlot(int s);
+    int64_t notDone(const uint64_t *doneBits) const;
+
+    int numTasks, numIters, words;
+    int base, window;
+    bool reversible;
+    std::vector<uint64_t> initial;  //TASK_STATUS_KINDS bitsets
+    std::vector<uint64_t> bits;     //window slots of TASK_STATUS_KINDS bitsets
+    std::vector<char> marked;
+    std::deque<Evicted> evicted;    //saved for rollback, oldest first
+    int64_t evictedNotDone;
+};
+
+#endif /* TASKSTATUS_H_ */
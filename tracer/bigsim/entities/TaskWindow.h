@@ -0,0 +1,84 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TASKWINDOW_H_
+#define TASKWINDOW_H_
+
+#include <stdint.h>
+#include <vector>
+#include "Task.h"
+
+//tasks [first, last] of a PE that may still be accessed
+struct TaskRange {
+  int64_t first, last;
+  TaskRange(int64_t _first, int64_t _last) : first(_first), last(_last) {}
+};
+
+/* Resident window over the tasks of a PE that are streamed from storage.
+ *
+ * Tasks are loaded in blocks of TASK_WINDOW_BLOCK by a loader callback and at
+ * most maxBlocks blocks are kept. When a block has to be loaded into a full
+ * window, the pin callback lists the tasks that may still be accessed (those
+ * executed but not yet committed and those referenced by pending messages),
+ * and a block without such tasks is dropped; a dropped block is loaded again
+ * from storage if it is needed later. If every block is pinned, the window
+ * grows past maxBlocks and shrinks back as blocks get unpinned. Task pointers
+ * stay valid as long as the task is pinned or being executed.
+ */
+#define TASK_WINDOW_BLOCK_SHIFT 8
+#define TASK_WINDOW_BLOCK (1 << TASK_WINDOW_BLOCK_SHIFT)
+
+class TaskWindow {
+  public:
+    typedef void (*Loader)(void *arg, int64_t first, int64_t count, Task *to);
+    typedef void (*Pins)(void *arg, std::vector<TaskRange> &pins);
+
+    TaskWindow();
+    ~TaskWindow();
+    void init(int64_t numTasks, int maxTasks, Loader loader, void *loaderArg,
+      Pins pins, void *pinsArg);
+
+    inline Task* get(int64_t id) {
+      int64_t b = id >> TASK_WINDOW_BLOCK_SHIFT;
+      if(b != lastBlock) touch(b);
+      return lastBase + (id & (TASK_WINDOW_BLOCK - 1));
+    }
+
+    int64_t loads, drops;
+    int maxResident; //most blocks ever resident
+
+  private:
+    void touch(int64_t b);
+    int findSlot(int64_t b);
+    int newSlot();
+    void drop(int s);
+
+    int64_t numTasks;
+    int maxBlocks;
+    Loader loader;
+    void *loaderArg;
+    Pins pins;
+    void *pinsArg;
+    std::vector<int32_t> slotOf;   //per block: slot holding it, or -1
+    std::vector<int64_t> blockOf;  //per slot: block it holds, or -1
+    std::vector<Task*> slots;      //NULL once released
+    int numLive;                   //slots that are not released
+    std::vector<TaskRange> pinned; //scratch for the pin callback
+    int64_t lastBlock;
+    Task *lastBase;
+};
+
+#endif /* TASKWINDOW_H_ */
@@ -9,6 +9,7 @@
 #include <otf2/otf2.h>
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 #include "entities/Task.h"
 
@@ -36,7 +37,33 @@ struct ClockProperties {
   uint64_t time_offset;
 };
 
+/* Global definitions are read once per node and published read-only to all
+ * ranks on it through an MPI-3 shared memory window. The image is flat and
+ * pointer-free: a DefsHeader followed by arrays located by byte offsets from
+ * the start of the image. All arrays are sorted by their OTF2 reference.
+ * Strings, regions and communicators also get a table indexed directly by
+ * reference when their references are dense (as OTF2 writers assign them);
+ * otherwise the number of slots is 0 and lookups binary search the array.
+ */
+struct DefsHeader {
+  uint64_t totalBytes;
+  ClockProperties clockProperties;
+  uint64_t numLocations, numStrings, numRegions;
+  uint64_t numGroups, numMembers, numComms;
+  uint64_t stringSlots, regionSlots, commSlots;
+  //byte offsets of the arrays
+  uint64_t locations, strings, stringData, regions;
+  uint64_t groups, members, ranks, comms;
+  uint64_t stringIndex, regionIndex, commIndex;
+};
+
+struct DefString {
+  uint64_t ref;
+  uint64_t offset; //into the NUL-terminated string data
+};
+
 struct Region {
+  uint64_t ref;
   OTF2_StringRef name;
   OTF2_RegionRole role;
   OTF2_Paradigm paradigm;
@@ -46,34 +73,104 @@ struct Region {
 };
 
 struct Group {
+  uint64_t ref;
+  uint64_t first; //index of the first member in the member/rank arrays
+  uint32_t size;
   OTF2_GroupType type;
-  std::vector<uint64_t> members;
-  std::map<int, int> rmembers;
+};
+
+//member -> rank in group, sorted by member within each group
+struct GroupRank {
+  uint64_t member;
+  uint64_t rank;
+};
+
+struct Comm {
+  uint64_t ref;
+  int64_t group; //index into the group array, -1 if undefined
+};
+
+struct GroupView {
+  const uint64_t *members;
+  const GroupRank *ranks;
+  uint32_t size;
+  /* rank of member in the group; -1 if it is not a member */
+  int rankOf(uint64_t member) const;
+};
+
+class GlobalDefs {
+  public:
+    GlobalDefs() : hdr(NULL) {}
+    void attach(const char *image);
+    const ClockProperties& clockProperties() const {
+      return hdr->clockProperties;
+    }
+    uint64_t numLocations() const { return hdr->numLocations; }
+    uint64_t location(uint64_t i) const { return locations[i]; }
+    uint64_t numComms() const { return hdr->numComms; }
+    const char* string(OTF2_StringRef ref) const;
+    uint64_t numRegions() const { return hdr->numRegions; }
+    const Region& regionAt(uint64_t i) const { return regions[i]; }
+    const Region& region(OTF2_RegionRef ref) const;
+    const char* regionName(OTF2_RegionRef ref) const {
+      return string(region(ref).name);
+    }
+    /* index of comm in [0, numComms()); -1 if it is not defined */
+    int64_t commIndex(OTF2_CommRef comm) const;
+    GroupView groupAt(int64_t commIndex) const;
+    OTF2_CommRef commRef(int64_t commIndex) const {
+      return comms[commIndex].ref;
+    }
+    GroupView group(OTF2_CommRef comm) const {
+      return groupAt(commIndex(comm));
+    }
+
+  private:
+    const DefsHeader *hdr;
+    const uint64_t *locations;
+    const DefString *strings;
+    const char *stringData;
+    const Region *regions;
+    const Group *groups;
+    const uint64_t *members;
+    const GroupRank *ranks;
+    const Comm *comms;
+    const int32_t *stringIndex, *regionIndex, *commIndexTable;
 };
 
 struct LocationData {
+  uint32_t pe; //PE of the job whose location is being read
   uint64_t lastLogTime;
   bool firstEnter;
   std::vector<Task> tasks;
 };
 
 struct AllData {
-  ClockProperties clockProperties;
-  std::vector<uint64_t> locations;
-  std::map<uint64_t, std::string> strings;
-  std::map<uint64_t,uint64_t> communicators;
-  std::map<uint64_t,Group> groups;
-  std::map<uint64_t,Region> regions;
+  GlobalDefs defs;
+  char *defsImage; //node-shared window, or private copy without MPI-3
+#if MPI_VERSION >= 3
+  MPI_Win defsWin;
+#endif
   LocationData *ld;
   std::map<int, int> matchRecvIds;//temp space
+  //local locations not selected in the reader as their task cache is valid
+  std::set<int> cachedLocs;
 };
 
 OTF2_Reader * readGlobalDefinitions(int jobID, char* tracefileName, 
   AllData *allData);
 
+/* Definitions of a job that is not read from an OTF2 archive: locations
+ * 0..numRanks-1, and communicator c over the ranks in commGroups[c] */
+void makeSyntheticDefinitions(int numRanks,
+  const std::vector<std::vector<uint64_t> > &commGroups, AllData *allData);
+
 void readLocationTasks(int jobID, OTF2_Reader *reader, AllData *allData, 
   uint32_t loc, LocationData* ld);
 
 void closeReader(OTF2_Reader *reader);
+
+/* Releases the definitions image; collective over the ranks of a node */
+void freeGlobalDefinitions(AllData *allData);
 #endif
 #endif
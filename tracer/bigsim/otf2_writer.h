@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _OTF2_WRITER_H_
+#define _OTF2_WRITER_H_
+#if TRACER_OTF_TRACES
+
+#include <stdint.h>
+#include <mpi.h>
+#include <otf2/otf2.h>
+#include <deque>
+#include "otf2_reader.h"
+
+// Predicted timeline of the replay, written as one OTF2 archive per job in
+// <dir>/job<id>/traces.otf2. Every PE is a location, regions and
+// communicators are copied from the definitions of the job, and timestamps
+// are simulated nanoseconds.
+
+enum TimelineKind {
+  TL_ENTER = 0,
+  TL_LEAVE,
+  TL_SEND,
+  TL_RECV,
+  TL_COLL_BEGIN,
+  TL_COLL_END
+};
+
+struct TimelineRecord {
+  const void *key;  // payload of the event that produced the record
+  uint64_t time;
+  uint64_t size;
+  uint32_t ref;     // region, or peer PE of a send/recv, or collective root
+  int32_t comm;
+  int32_t tag;
+  uint8_t kind;
+  uint8_t collOp;
+};
+
+/* Records of a PE. In optimistic mode they are kept until the event that
+ * produced them commits, or dropped if it is rolled back; otherwise they
+ * are written right away. */
+class Timeline {
+  public:
+    Timeline(OTF2_EvtWriter *writer, const GlobalDefs *defs, bool reversible);
+    void enter(const void *key, double time, uint32_t region);
+    void leave(const void *key, double time, uint32_t region);
+    void send(const void *key, double time, int dest, int comm, int tag,
+      uint64_t size);
+    void recv(const void *key, double time, int src, int comm, int tag,
+      uint64_t size);
+    void collBegin(const void *key, double time);
+    void collEnd(const void *key, double time, int collOp, int comm,
+      uint32_t root, uint64_t size);
+    //the event with payload key was rolled back
+    void undo(const void *key) {
+      while(!pending.empty() && pending.back().key == key) pending.pop_back();
+    }
+    //the event with payload key has committed
+    void commit(const void *key) {
+      while(!pending.empty() && pending.front().key == key) {
+        write(pending.front());
+        pending.pop_front();
+      }
+    }
+    //write what is left and close the writer; returns the events written
+    uint64_t close(OTF2_Archive *archive);
+
+  private:
+    void add(const TimelineRecord &r);
+    void write(const TimelineRecord &r);
+    uint32_t rankIn(int comm, int pe) const;
+
+    OTF2_EvtWriter *writer;
+    const GlobalDefs *defs;
+    bool reversible;
+    std::deque<TimelineRecord> pending;
+};
+
+/* Open the archives of numJobs jobs in dir, collective over comm */
+void timelineOpen(const char *dir, int numJobs, MPI_Comm comm);
+
+Timeline* timelineNew(int job, int pe, const GlobalDefs *defs,
+  bool reversible);
+
+/* Close the timeline of a local PE */
+void timelineDone(int job, int pe, Timeline *timeline);
+
+/* Write the definitions of job and close its archive, collective over the
+ * comm given to timelineOpen; endTime is the last simulated time in ns */
+void timelineClose(int job, int numRanks, const GlobalDefs *defs,
+  double endTime);
+
+#endif
+#endif
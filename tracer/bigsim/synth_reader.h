@@ -0,0 +1,94 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SYNTH_READER_H_
+#define _SYNTH_READER_H_
+#if TRACER_OTF_TRACES
+
+#include <stdint.h>
+#include <vector>
+#include "otf2_reader.h"
+
+/* Synthetic workloads: instead of an OTF2 archive, the trace path of a job
+ * can name a motif file (ending in .motif) that describes one iteration of
+ * the application as a list of phases. Every PE generates its own tasks from
+ * the motif when it is initialized, using the same Task/MsgEntry model as the
+ * OTF2 reader, so no trace is read from disk. The generated tasks depend only
+ * on the motif, the seed and the rank.
+ *
+ * Motif file, one directive per line, '#' starts a comment:
+ *   iterations <n>                 iterations generated (default 1)
+ *   seed <n>                       seed of jitter and permutations
+ *   compute <us> [jitter <f>]      computation of us microseconds, spread
+ *                                  uniformly by +-f of that time per rank
+ *   stencil <d0>x<d1>[x..] <bytes> [periodic]
+ *                                  halo exchange with the 2 neighbors along
+ *                                  every dimension of a rank grid
+ *   transpose <px>x<py> <bytes>    FFT transpose: alltoall among the rows,
+ *                                  then among the columns of a px by py grid
+ *   alltoall <bytes>               alltoall over all ranks
+ *   allreduce <bytes>              allreduce over all ranks
+ *   permutation <bytes>            every rank sends to one pseudo random
+ *                                  partner, a new permutation each iteration
+ * Every phase directive but iterations and seed takes an optional
+ * "every <k>" so that it only runs in every k-th iteration. Message sizes are
+ * per destination.
+ */
+
+#define MOTIF_MAX_DIMS 8
+
+enum MotifPhaseType {
+  MOTIF_COMPUTE = 0,
+  MOTIF_STENCIL,
+  MOTIF_TRANSPOSE,
+  MOTIF_ALLTOALL,
+  MOTIF_ALLREDUCE,
+  MOTIF_PERMUTATION
+};
+
+struct MotifPhase {
+  MotifPhaseType type;
+  int every;
+  double time;      //compute: ns
+  double jitter;
+  uint64_t bytes;
+  int numDims;
+  int dims[MOTIF_MAX_DIMS];
+  bool periodic;
+  int firstComm;    //transpose: communicator of the first row; the columns
+                    //follow the rows
+};
+
+struct Motif {
+  int numRanks;
+  int iterations;
+  uint64_t seed;
+  std::vector<MotifPhase> phases;
+  //members of the communicators the motif uses, 0 is all ranks
+  std::vector<std::vector<uint64_t> > commGroups;
+};
+
+bool isMotifPath(const char *path);
+
+/* Read the motif of a job on rank 0 and broadcast it; aborts if the motif is
+ * malformed or does not fit numRanks */
+Motif* loadMotif(const char *path, int numRanks);
+
+/* Tasks of rank pe in the motif; they stay allocated for the whole run */
+Task* generateMotifTasks(const Motif *motif, int pe, int64_t *numTasks);
+
+#endif
+#endif
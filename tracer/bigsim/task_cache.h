@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TASK_CACHE_H_
+#define _TASK_CACHE_H_
+#if TRACER_OTF_TRACES
+
+#include <stdint.h>
+#include "entities/Task.h"
+
+// Binary cache of the tasks produced by the OTF2 callbacks. One shard is
+// kept per location in <trace>.cache/<location>.tasks so that every MPI rank
+// only touches the locations mapped to it. A shard is a TaskCacheHeader
+// followed by the raw Task array, and is mapped back in place on load.
+#define TASK_CACHE_VERSION 2
+
+enum TaskCacheMode {
+  TASK_CACHE_OFF = 0,     // always parse the trace
+  TASK_CACHE_USE = 1,     // load valid shards, parse and write the rest
+  TASK_CACHE_REBUILD = 2  // parse the trace and overwrite all shards
+};
+
+struct TaskCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t taskSize;
+  uint32_t noCommBuild;
+  uint32_t location;
+  int64_t numTasks;
+  double softDelay;     // soft_delay_mpi is baked into MPI task times
+  int64_t traceMtime;   // invalidate the shard if the trace is rewritten
+  int64_t traceSize;
+  char pad[8];
+};
+
+bool taskCacheValid(int jobID, int loc);
+
+/* Map the shard of location loc; returns NULL if it is missing or stale */
+Task* taskCacheLoad(int jobID, int loc, int64_t *numTasks);
+
+/* Open the shard of location loc for taskCacheRead; returns -1 if it is
+ * missing, stale or empty */
+int taskCacheOpen(int jobID, int loc, int64_t *numTasks);
+
+/* Read tasks [first, first + count) of an open shard */
+void taskCacheRead(int fd, int64_t first, int64_t count, Task *to);
+
+void taskCacheStore(int jobID, int loc, const Task *tasks, int64_t numTasks);
+
+#endif
+#endif
@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef _EVENT_LOG_H_
+#define _EVENT_LOG_H_
+
+#include <pthread.h>
+#include <stdint.h>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#define EVENT_LOG_MAGIC "TRACELOG"
+#define EVENT_LOG_VERSION 1
+
+/* Kinds of records. ELOG_COMMIT is written when an event commits; the others
+ * are diagnostics written while an event is processed, so in optimistic mode
+ * they include events that are later rolled back. */
+enum EventLogKind {
+  ELOG_COMMIT = 0,
+  ELOG_KICKOFF_REV,
+  ELOG_RECV_MSG,
+  ELOG_RECV_FOUND,
+  ELOG_RECV_BUSY,
+  ELOG_RECV_REV,
+  ELOG_SET_BUSY,
+  ELOG_EXEC_REV,
+  ELOG_RECV_POSTED,
+  ELOG_POST_IRECV,
+  ELOG_PUSH_RECV,
+  ELOG_RECV_MATCHED,
+  ELOG_RECV_POST,
+  ELOG_SEND,
+  ELOG_SELF_SEND,
+  ELOG_KINDS
+};
+
+/* printf formats of the arguments of each kind, for the decoder */
+static const char * const event_log_formats[ELOG_KINDS] = {
+  "commit iter %lld from %lld id %lld size %lld",
+  "kickoff reversed",
+  "recv msg from %lld id %lld comm %lld seq %lld",
+  "recv msg from %lld id %lld comm %lld seq %lld found task %lld",
+  "recv msg busy %lld task %lld",
+  "recv msg reversed id %lld task %lld was busy %lld",
+  "set busy %lld task %lld",
+  "exec task reversed task %lld",
+  "recv post from %lld id %lld comm %lld seq %lld matched task %lld",
+  "post irecv req %lld from %lld id %lld comm %lld seq %lld",
+  "push recv task %lld from %lld id %lld comm %lld seq %lld",
+  "recv matched task %lld from %lld id %lld comm %lld seq %lld",
+  "send recv post to %lld id %lld comm %lld seq %lld",
+  "send to %lld id %lld comm %lld seq %lld task %lld",
+  "send to self id %lld comm %lld seq %lld"
+};
+
+struct EventLogHeader {
+  char magic[8];        // EVENT_LOG_MAGIC
+  int32_t version;      // EVENT_LOG_VERSION
+  int32_t recordSize;   // sizeof(EventLogRecord)
+  int32_t rank;
+  int32_t numTypes;     // event type names that follow the header
+  int64_t namesBytes;   // NUL terminated, one after the other
+};
+
+struct EventLogRecord {
+  double time;          // simulated time in seconds
+  int32_t job, pe;
+  int16_t kind;         // EventLogKind
+  int16_t type;         // proc_event being processed
+  int32_t unused;
+  int64_t args[5];
+};
+
+/* Binary event log of a rank. Records are appended to a ring buffer without
+ * blocking, and a background thread writes them to the file; records that
+ * find the buffer full are dropped and counted. Which records are kept is
+ * selected by job, PE and event type. */
+class EventLog {
+  public:
+    EventLog();
+    //comma separated lists of numbers and ranges (a-b), and of event type
+    //names; NULL or empty selects everything. False if a list is malformed.
+    bool select(const char *jobList, const char *peList, const char *typeList,
+      const char * const *typeNames, int numTypes);
+    bool open(const char *fileName, int rank, int capacity,
+      const char * const *typeNames, int numTypes);
+    //write what is left and stop the writer
+    void close();
+
+    inline bool on() const { return active; }
+    inline bool selects(int job, int pe, int type) const {
+      return ((typeMask >> type) & 1) && inRanges(jobs, job) &&
+        inRanges(pes, pe);
+    }
+    inline void append(EventLogKind kind, double time, int job, int pe,
+      int type, int64_t a0 = 0, int64_t a1 = 0, int64_t a2 = 0,
+      int64_t a3 = 0, int64_t a4 = 0) {
+      uint64_t h = head;
+      if(h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) == ring.size()) {
+        dropped++;
+        return;
+      }
+      EventLogRecord &r = ring[h % ring.size()];
+      r.time = time;
+      r.job = job;
+      r.pe = pe;
+      r.kind = kind;
+      r.type = type;
+      r.unused = 0;
+      r.args[0] = a0;
+      r.args[1] = a1;
+      r.args[2] = a2;
+      r.args[3] = a3;
+      r.args[4] = a4;
+      __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+    }
+
+    int64_t written() const { return head; }
+    int64_t dropped;
+
+  private:
+    typedef std::vector<std::pair<int, int> > Ranges;
+    static bool parseRanges(const char *list, Ranges &ranges);
+    static inline bool inRanges(const Ranges &ranges, int v) {
+      if(ranges.empty()) return true;
+      for(size_t i = 0; i < ranges.size(); i++) {
+        if(v >= ranges[i].first && v <= ranges[i].second) return true;
+      }
+      return false;
+    }
+    static void* writerMain(void *arg);
+    //write the records appended so far, false if there were none
+    bool drain();
+
+    bool active;
+    Ranges jobs, pes;
+    uint64_t typeMask;
+    std::vector<EventLogRecord> ring;
+    uint64_t head, tail;  //appended by the simulation, written by the writer
+    int stop;
+    FILE *out;
+    pthread_t writer;
+};
+
+#endif
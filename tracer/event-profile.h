@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _EVENT_PROFILE_H_
+#define _EVENT_PROFILE_H_
+
+#include <mpi.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define TRACER_PROF_BINS 40
+
+enum ProfileDirection {
+  PROF_FORWARD = 0,
+  PROF_REVERSE = 1
+};
+
+struct EventTypeProfile {
+  uint64_t count[2];    // events processed, by direction
+  uint64_t samples[2];  // events timed
+  uint64_t cycles[2];   // summed over the timed events
+  uint64_t hist[2][TRACER_PROF_BINS]; // timed events by log2 of their cycles
+};
+
+/* Counts of the events of each type processed and rolled back by an LP, and
+ * the cycles spent in one of every period of them. Profiles of LPs are added
+ * up into profiles of a rank or a job.
+ */
+class EventProfile {
+  public:
+    EventProfile() : period(1), counter(0) {}
+    void init(int numTypes, unsigned int period);
+
+    inline void count(int type, ProfileDirection dir) {
+      types[type].count[dir]++;
+    }
+    //should the next event be timed?
+    inline bool sample() {
+      if(++counter < period) return false;
+      counter = 0;
+      return true;
+    }
+    void record(int type, ProfileDirection dir, uint64_t cycles);
+
+    void add(const EventProfile &other);
+    //sum the profiles of all ranks of comm on root
+    void reduce(int root, MPI_Comm comm);
+    bool empty() const;
+    //one line per event type that has events, starting with prefix
+    std::string format(const char *prefix, const char * const *names,
+      bool histograms) const;
+
+    std::vector<EventTypeProfile> types;
+
+  private:
+    unsigned int period, counter;
+};
+
+#endif
@@ -0,0 +1,50 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _MAP_FILE_H_
+#define _MAP_FILE_H_
+
+#include <stdint.h>
+
+/* Indexed map file: the global map and the maps of all jobs in one file, so
+ * that every rank can read just the parts it needs. Layout:
+ *   MapFileHeader
+ *   MapFileJob[numJobs]
+ *   at globalOffset: numServers pairs of int32 <local rank> <job id>, one per
+ *     global rank in order, -1 -1 for global ranks without a job
+ *   at MapFileJob.offset: numRanks int32 global ranks of the job, one per
+ *     local rank in order
+ * Offsets are in bytes from the start of the file, and all values are in the
+ * byte order of the machine that wrote the file. utils/map_index converts a
+ * global map file and its job map files to this format.
+ */
+#define TRACER_MAP_MAGIC "TRACEMAP"
+#define TRACER_MAP_VERSION 1
+
+struct MapFileHeader {
+  char magic[8];
+  int32_t version;
+  int32_t numJobs;
+  int64_t numServers;
+  int64_t globalOffset;
+};
+
+struct MapFileJob {
+  int64_t numRanks;
+  int64_t offset;
+};
+
+#endif
@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _MSG_HISTOGRAM_H_
+#define _MSG_HISTOGRAM_H_
+
+#include <mpi.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define TRACER_MSG_SIZE_BINS 40 // by log2 of the message size in bytes
+#define TRACER_MSG_LAT_BINS 40  // by log2 of the latency in ns
+
+enum MsgCategory {
+  MSG_P2P = 0,
+  MSG_COLL = 1,
+  MSG_CATEGORIES
+};
+
+enum MsgProtocol {
+  MSG_EAGER = 0,
+  MSG_RENDEZVOUS = 1,
+  MSG_PROTOCOLS
+};
+
+struct MsgSizeClass {
+  uint64_t count;
+  uint64_t bytes;
+  uint64_t latencySum;  // ns
+  uint64_t latency[TRACER_MSG_LAT_BINS];
+};
+
+/* Latency and size of the network messages of every job, in log2 buckets:
+ * for each category, protocol and size class (bin b holds sizes in
+ * [2^b, 2^(b+1)), bin 0 also 0 and 1), a latency histogram. Messages are
+ * added when their delivery commits, so rolled back events are never
+ * counted.
+ */
+class MsgHistograms {
+  public:
+    void init(int numJobs);
+    void record(int job, MsgCategory cat, MsgProtocol proto, uint64_t size,
+      double latency);
+    //sum the histograms of all ranks of comm on root, in one reduction
+    void reduce(int root, MPI_Comm comm);
+    bool empty(int job) const;
+    //one line per size class that has messages
+    std::string format(int job) const;
+    //one line per category and protocol that has messages
+    std::string summary(int job) const;
+
+  private:
+    MsgSizeClass& at(int job, int cat, int proto, int sizeBin) {
+      return classes[((job * MSG_CATEGORIES + cat) * MSG_PROTOCOLS + proto) *
+        TRACER_MSG_SIZE_BINS + sizeBin];
+    }
+    const MsgSizeClass& at(int job, int cat, int proto, int sizeBin) const {
+      return classes[((job * MSG_CATEGORIES + cat) * MSG_PROTOCOLS + proto) *
+        TRACER_MSG_SIZE_BINS + sizeBin];
+    }
+
+    std::vector<MsgSizeClass> classes;
+};
+
+#endif
@@ -0,0 +1,111 @@
+//////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2015, Lawrence Livermore National Security, LLC.
+// Produced at the Lawrence Livermore National Laboratory.
+//
+// Written by:
+//     Nikhil Jain <nikhil.jain@acm.org>
+//     Bilge Acun <acun2@illinois.edu>
+//     Abhinav Bhatele <bhatele@llnl.gov>
+//
+// LLNL-CODE-681378. All rights reserved.
+//
+// This file is part of TraceR. For details, see:
+// https://github.com/LLNL/tracer
+// Please also read the LICENSE file for our notice and the LGPL.
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PLACEMENT_H_
+#define _PLACEMENT_H_
+
+#include <mpi.h>
+#include <stdint.h>
+#include <map>
+#include <utility>
+#include <vector>
+
+/* Graph of the point-to-point messages between the servers of all jobs,
+ * weighted by the number of tasks of each server and the number of messages
+ * between two servers. Every rank adds the servers it simulates; the graph
+ * is then gathered on one rank, which partitions it over the MPI ranks and
+ * compares placements by the fraction of messages that cross ranks and the
+ * load imbalance.
+ */
+class CommGraph {
+  public:
+    CommGraph() : numVertices(0) {}
+    void init(int numVertices);
+    inline void setWeight(int v, int64_t tasks) { weight[v] = tasks; }
+    inline void addEdge(int from, int to, int64_t messages) {
+      localEdges[std::make_pair(from, to)] += messages;
+    }
+
+    //collect the weights and edges of all ranks of comm on root
+    void gather(int root, MPI_Comm comm);
+
+    //place the servers that have tasks on parts ranks, keeping the weight
+    //of each rank within (1 + tolerance) of the average; servers without
+    //tasks keep the part given in part on input
+    void partition(int parts, double tolerance, std::vector<int> &part) const;
+    //fraction of the messages between different parts, and the largest
+    //weight of a part over the average weight
+    void evaluate(const std::vector<int> &part, int parts, double *remote,
+      double *imbalance) const;
+
+    int64_t totalMessages() const;
+    int64_t weightOf(int v) const { return weight[v]; }
+
+  private:
+    void buildAdjacency();
+    void refine(int parts, int64_t maxWeight, std::vector<int> &part,
+      std::vector<int64_t> &partWeight) const;
+
+    int numVertices;
+    std::vector<int64_t> weight;
+    std::map<std::pair<int, int>, int64_t> localEdges;
+    //on root after gather: directed edges, and the undirected adjacency
+    std::vector<int64_t> edges; // from, to, messages
+    std::vector<int64_t> adjStart;
+    std::vector<int> adjTo;
+    std::vector<int64_t> adjMessages;
+};
+
+/* Messages between servers and tasks seen by the servers of one rank while
+ * the model runs, to check the placement the run actually used */
+class PlacementCounts {
+  public:
+    PlacementCounts() : messages(0), remoteMessages(0), tasks(0) {}
+    inline void message(int64_t count, bool remote) {
+      messages += count;
+      if(remote) remoteMessages += count;
+    }
+    inline void task() { tasks++; }
+
+    //on root: the fraction of the messages that crossed ranks, and the
+    //largest task count of a rank over the average
+    void reduce(int root, MPI_Comm comm, int64_t *total, double *remote,
+      double *imbalance) const;
+
+  private:
+    int64_t messages, remoteMessages, tasks;
+};
+
+/* A partition of the servers over parts ranks, written by the analysis of one
+ * run so that a later run places its servers by it; remote and imbalance are
+ * what the analysis predicted for it */
+struct PlacementFileHeader {
+  char magic[8];
+  int32_t version;
+  int32_t numServers;
+  int32_t parts;
+  int32_t pad;
+  double remote, imbalance;
+};
+#define PLACEMENT_FILE_VERSION 1
+
+bool writePlacement(const char *file, const std::vector<int> &part,
+  int parts, double remote, double imbalance);
+/* false if the file is missing or was written for other servers or ranks */
+bool readPlacement(const char *file, int numServers, int parts,
+  std::vector<int> &part, double *remote, double *imbalance);
+
+#endif
@@ -5,9 +5,19 @@
 #include "bigsim/CWrapper.h"
 #include "bigsim/entities/MsgEntry.h"
 #include "bigsim/entities/PE.h"
+#include "event-profile.h"
+#include "event-log.h"
+#include "msg-histogram.h"
+#include "placement.h"
+#include "map-file.h"
+#include "bigsim/checkpoint.h"
+#include <cstddef>
 
 #if TRACER_OTF_TRACES
 #include "bigsim/otf2_reader.h"
+#include "bigsim/synth_reader.h"
+#include "bigsim/task_cache.h"
+#include "bigsim/otf2_writer.h"
 #endif
 
 #define BCAST_DEGREE  2
@@ -17,6 +27,16 @@ typedef struct CoreInf {
     int mapsTo, jobID;
 } CoreInf;
 
+/* completion times of the iterations of a job, kept by its PE 0 to detect
+ * steady state */
+struct IterTracker {
+    std::vector<int> arrived;      /* PEs that finished each iteration */
+    std::vector<tw_stime> doneAt;  /* time the last of them finished it */
+    int maxIter;                   /* latest iteration finished by any PE */
+    int stopIter;                  /* -1 until steady state is detected */
+    tw_stime iterTime;             /* mean iteration time at steady state */
+};
+
 struct proc_state
 {
     int msg_sent_count;   /* requests sent */
@@ -30,6 +50,13 @@ struct proc_state
 #endif
     clock_t sim_start;
     int my_pe_num, my_job;
+    IterTracker *iters; /* PE 0 of a job with steady state detection */
+    tw_stime steady_iter_time; /* from ITER_STOP, 0 if the PE is not stopped */
+    EventProfile *profile; /* events handled, if profiling */
+#if TRACER_OTF_TRACES
+    Timeline *timeline; /* predicted timeline of the PE, if written */
+    tw_stime stopped_at; /* start of checkpoint_iter, -1 until reached */
+#endif
 };
 
 /* types of events that will constitute triton requests */
@@ -53,23 +80,65 @@ enum proc_event
     COLL_A2A_BLOCKED,
     COLL_A2A_BLOCKED_SEND_DONE,
     RECV_COLL_POST,
-    COLL_COMPLETE
+    COLL_COMPLETE,
+    COLL_ANALYTIC, /* arrival at the root of a collective modeled analytically */
+    RECV_MSG_BATCH, /* bigsim, small messages of a task coalesced into one */
+    ITER_DONE, /* to PE 0 of the job, a PE finished an iteration */
+    ITER_STOP, /* from PE 0 of the job, leave the loop after an iteration */
+    NUM_PROC_EVENTS /* number of event types, not an event */
+};
+
+/* maximum number of messages coalesced into a RECV_MSG_BATCH */
+#define TRACER_BATCH_MAX 4
+
+struct BatchEntry {
+    int id;
+    int size;
 };
 
+/* The fields set by the sender of an event come first: the header of every
+ * event, the messages of a RECV_MSG_BATCH, and the task of the self event
+ * of a collective send. Only those are sent with model_net_event, see
+ * proc_msg_wire_size; the rest is written by the handler of the event for
+ * its reverse handler. */
 struct proc_msg
 {
     enum proc_event proc_event_type;
-    tw_lpid src;          /* source of this request or ack */
     int iteration;
+    tw_stime sent_at; /* time a message entered the network, -1 if it did not */
+    MsgID msgId;
+#if TRACER_BIGSIM_TRACES
+    int batch_count;
+    BatchEntry batch[TRACER_BATCH_MAX]; /* messages in a RECV_MSG_BATCH */
+#endif
     TaskPair executed;
     int fwd_dep_count;
     int saved_task;
-    MsgID msgId;
-    bool incremented_flag; /* helper for reverse computation */
     int model_net_calls;
     unsigned int coll_info;
+    bool incremented_flag; /* helper for reverse computation */
+    tw_stime iter_time; /* steady iteration time, with ITER_STOP */
 };
 
+/* bytes of a proc_msg sent over the network with an event of type t */
+static inline int proc_msg_wire_size(enum proc_event t) {
+#if TRACER_BIGSIM_TRACES
+  if(t == RECV_MSG_BATCH) return offsetof(proc_msg, executed);
+#endif
+  return offsetof(proc_msg, msgId) + sizeof(MsgID);
+}
+
+/* bytes of a proc_msg sent with the self event of a model_net_event */
+static inline int proc_msg_self_size() {
+  return offsetof(proc_msg, executed) + sizeof(TaskPair);
+}
+
+/* receive time of the event whose payload is m; unlike tw_now, also valid
+ * when the event commits */
+static inline tw_stime event_time(proc_msg *m) {
+  return ((tw_event*)m - 1)->recv_ts;
+}
+
 struct Coll_lookup {
   proc_event remote_event, local_event;
 };
@@ -87,9 +156,46 @@ static void proc_rev_event(
     tw_bf * b,
     proc_msg * m,
     tw_lp * lp);
+static void proc_commit_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
 static void proc_finalize(
     proc_state * ns,
     tw_lp * lp);
+static void dispatch_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
+static void dispatch_rev_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
+static void write_event_profiles();
+static void record_msg(proc_state * ns, proc_msg * m);
+static void write_msg_histograms();
+static void add_placement_edges(proc_state * ns);
+static void write_placement();
+static void count_placement(proc_state * ns, tw_bf * b, proc_msg * m);
+static void report_placement();
+static void report_msg_sizes();
+static void start_event_log();
+static void stop_event_log();
+#if TRACER_ENSEMBLE
+static void setup_ensemble(int argc, char **argv, char *conf);
+#endif
+static bool pe_state_restored();
+static int same_pe_placement();
+static PE* share_pe(PE *pe, int job, int peNum, tw_stime *startTime);
+static void read_global_map(const char *fileName);
+static int open_indexed_map(const char *fileName, MPI_File *fh,
+  MapFileHeader &header);
+static void read_indexed_global_map(MPI_File fh, const MapFileHeader &header);
+static void read_indexed_job_map(MPI_File fh, const MapFileHeader &header,
+  int job);
 
 //event handler declarations
 static void handle_kickoff_event(
@@ -147,6 +253,21 @@ static void handle_recv_post_event(
     tw_bf * b,
     proc_msg * m,
    tw_lp * lp);
+static void handle_recv_batch_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+   tw_lp * lp);
+static void handle_iter_done_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+   tw_lp * lp);
+static void handle_iter_stop_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+   tw_lp * lp);
 
 //reverse event handler declarations
 static void handle_kickoff_rev_event(
@@ -204,6 +325,21 @@ static void handle_recv_post_rev_event(
     tw_bf * b,
     proc_msg * m,
     tw_lp * lp);
+static void handle_recv_batch_rev_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
+static void handle_iter_done_rev_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
+static void handle_iter_stop_rev_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
 
 static tw_stime exec_task(
     proc_state * ns,
@@ -232,6 +368,41 @@ static int send_msg(
     bool fillSz = false,
     int64_t size2 = 0);
 
+#if TRACER_BIGSIM_TRACES
+/* small messages of a task on their way to one destination */
+struct MsgBatch {
+    int dest_id, pe, count;
+    int64_t size;
+    tw_stime sendOffset;
+    BatchEntry entries[TRACER_BATCH_MAX];
+};
+
+#define TRACER_OPEN_BATCHES 8
+
+struct MsgBatcher {
+    int numOpen;
+    MsgBatch open[TRACER_OPEN_BATCHES];
+};
+
+static void send_or_batch(
+    proc_state * ns,
+    MsgBatcher *batcher,
+    int size,
+    int iter,
+    MsgID *msgId,
+    int dest_id,
+    tw_stime sendOffset,
+    tw_lp * lp,
+    proc_msg *m);
+
+static void flush_batches(
+    proc_state * ns,
+    MsgBatcher *batcher,
+    int iter,
+    tw_lp * lp,
+    proc_msg *m);
+#endif
+
 static void enqueue_msg(
     proc_state * ns,
     int size,
@@ -347,6 +518,19 @@ static void handle_coll_complete_event(
     proc_msg * m,
     tw_lp * lp);
 
+static void perform_analytic_coll(
+    proc_state * ns,
+    int task_id,
+    tw_lp * lp,
+    proc_msg *m,
+    tw_bf * b);
+
+static void handle_coll_analytic_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
+
 static int send_coll_comp(
     proc_state * ns,
     tw_stime sendOffset,
@@ -430,6 +614,19 @@ static void handle_coll_complete_rev_event(
     proc_msg * m,
     tw_lp * lp);
 
+static void perform_analytic_coll_rev(
+    proc_state * ns,
+    int task_id,
+    tw_lp * lp,
+    proc_msg *m,
+    tw_bf * b);
+
+static void handle_coll_analytic_rev_event(
+    proc_state * ns,
+    tw_bf * b,
+    proc_msg * m,
+    tw_lp * lp);
+
 static int send_coll_comp_rev(
     proc_state * ns,
     tw_stime sendOffset,